@@ -0,0 +1,5 @@
+// Explicit instantiations of the kinetic event scheduler for float and double, see QuadraticEquationSolver.cpp
+#include "QuadraticEquationKineticScheduler.h"
+
+template class KineticEventScheduler<float>;
+template class KineticEventScheduler<double>;
@@ -0,0 +1,323 @@
+#pragma once
+
+#ifndef _QUADRATIC_EQUATION_KINETIC_SCHEDULER_
+#define _QUADRATIC_EQUATION_KINETIC_SCHEDULER_
+
+#include <cstddef>
+#include <vector>
+#include "QuadraticEquationSolver.h"
+
+// Event queue for kinetic simulations, e.g. collision or crossing time prediction.
+// Every equation a * t^2 + b * t + c = 0 is given by an id, where t is the absolute time,
+// and its event time is the earliest root later than the current time.
+// An indexed binary heap keeps the earliest event on top and allows to update any id in place.
+template <typename T>
+class KineticEventScheduler
+{
+public:
+    KineticEventScheduler(const T now = 0);
+    ~KineticEventScheduler();
+    void set(const size_t id, const T a, const T b, const T c);
+    void set_batch(const size_t *id, const T *a, const T *b, const T *c, const size_t n);
+    void erase(const size_t id);
+    bool contains(const size_t id) const;
+    T event_time(const size_t id) const;
+    bool empty() const;
+    size_t size() const;
+    size_t top() const;
+    T top_time() const;
+    bool pop(size_t &id, T &t);
+    T now() const;
+    static T earliest_root(const T a, const T b, const T c, const T after);
+
+private:
+    T current;
+    std::vector<size_t> heap; // ids ordered as a binary min heap of event times
+    std::vector<size_t> pos;  // position of an id in `heap`, or npos
+    std::vector<T> time;      // event time of an id
+    std::vector<T> scratch;   // event times solved by `set_batch`, kept to avoid allocating on every call
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    static constexpr T inf = std::numeric_limits<T>::infinity();
+    void reserve_id(const size_t id);
+    void assign(const size_t id, const T t);
+    void place(const size_t i, const size_t id);
+    void sift_up(size_t i);
+    void sift_down(size_t i);
+    void remove_at(const size_t i);
+    void rebuild();
+};
+
+template <typename T>
+KineticEventScheduler<T>::KineticEventScheduler(const T now)
+    : current(now)
+{
+    static_assert(std::is_same_v<T, double> || std::is_same_v<T, float>, "Only support float or double type");
+}
+
+template <typename T>
+KineticEventScheduler<T>::~KineticEventScheduler()
+{
+}
+
+template <typename T>
+T KineticEventScheduler<T>::earliest_root(const T a, const T b, const T c, const T after)
+{
+    // only isolated roots are events, so ALL_REAL (always zero) never triggers one,
+    // and an overflowed result may still have one finite root
+    T x1(0), x2(0);
+    QuadtraticEquationSolver<T> solver(a, b, c);
+    const SolverState s = solver.solve(x1, x2);
+    if (TWO_REAL != s && ONE_REAL != s && OVER_UNDER_FLOW != s)
+    {
+        return inf;
+    }
+    T t = inf;
+    if (std::isfinite(x1) && x1 > after)
+    {
+        t = x1;
+    }
+    if (ONE_REAL != s && std::isfinite(x2) && x2 > after && x2 < t)
+    {
+        t = x2;
+    }
+    return t;
+}
+
+template <typename T>
+void KineticEventScheduler<T>::reserve_id(const size_t id)
+{
+    if (id >= pos.size())
+    {
+        pos.resize(id + 1, npos);
+        time.resize(id + 1, inf);
+    }
+}
+
+template <typename T>
+void KineticEventScheduler<T>::place(const size_t i, const size_t id)
+{
+    heap[i] = id;
+    pos[id] = i;
+}
+
+template <typename T>
+void KineticEventScheduler<T>::sift_up(size_t i)
+{
+    const size_t id = heap[i];
+    const T t = time[id];
+    while (i > 0)
+    {
+        const size_t parent = (i - 1) >> 1;
+        if (!(t < time[heap[parent]]))
+        {
+            break;
+        }
+        place(i, heap[parent]);
+        i = parent;
+    }
+    place(i, id);
+}
+
+template <typename T>
+void KineticEventScheduler<T>::sift_down(size_t i)
+{
+    const size_t n = heap.size();
+    const size_t id = heap[i];
+    const T t = time[id];
+    while (true)
+    {
+        size_t child = 2 * i + 1;
+        if (child >= n)
+        {
+            break;
+        }
+        if (child + 1 < n && time[heap[child + 1]] < time[heap[child]])
+        {
+            ++child;
+        }
+        if (!(time[heap[child]] < t))
+        {
+            break;
+        }
+        place(i, heap[child]);
+        i = child;
+    }
+    place(i, id);
+}
+
+template <typename T>
+void KineticEventScheduler<T>::remove_at(const size_t i)
+{
+    const size_t id = heap[i];
+    const size_t last = heap.back();
+    heap.pop_back();
+    pos[id] = npos;
+    if (i < heap.size())
+    {
+        place(i, last);
+        sift_up(i);
+        sift_down(pos[last]);
+    }
+}
+
+template <typename T>
+void KineticEventScheduler<T>::rebuild()
+{
+    for (size_t i = heap.size() >> 1; i-- > 0;)
+    {
+        sift_down(i);
+    }
+}
+
+template <typename T>
+void KineticEventScheduler<T>::assign(const size_t id, const T t)
+{
+    // keep only the ids which really have a future event in the heap
+    reserve_id(id);
+    time[id] = t;
+    const size_t i = pos[id];
+    if (t == inf)
+    {
+        if (i != npos)
+        {
+            remove_at(i);
+        }
+        return;
+    }
+    if (i == npos)
+    {
+        heap.push_back(id);
+        pos[id] = heap.size() - 1;
+        sift_up(heap.size() - 1);
+        return;
+    }
+    sift_up(i);
+    sift_down(pos[id]);
+}
+
+template <typename T>
+void KineticEventScheduler<T>::set(const size_t id, const T a, const T b, const T c)
+{
+    assign(id, earliest_root(a, b, c, current));
+}
+
+template <typename T>
+void KineticEventScheduler<T>::set_batch(const size_t *id, const T *a, const T *b, const T *c, const size_t n)
+{
+    // solve all the equations first, then either fix the heap one by one,
+    // or rebuild it at once when a large part of it is invalidated
+    scratch.resize(n);
+    T *t = scratch.data();
+    for (size_t i = 0; i < n; ++i)
+    {
+        t[i] = earliest_root(a[i], b[i], c[i], current);
+    }
+    if (4 * n < heap.size())
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            assign(id[i], t[i]);
+        }
+        return;
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        reserve_id(id[i]);
+        time[id[i]] = t[i];
+        if (t[i] != inf && pos[id[i]] == npos)
+        {
+            heap.push_back(id[i]);
+            pos[id[i]] = heap.size() - 1;
+        }
+    }
+    size_t k = 0;
+    for (size_t i = 0; i < heap.size(); ++i)
+    {
+        if (time[heap[i]] == inf)
+        {
+            pos[heap[i]] = npos;
+            continue;
+        }
+        place(k++, heap[i]);
+    }
+    heap.resize(k);
+    rebuild();
+}
+
+template <typename T>
+void KineticEventScheduler<T>::erase(const size_t id)
+{
+    if (contains(id))
+    {
+        remove_at(pos[id]);
+    }
+    if (id < time.size())
+    {
+        time[id] = inf;
+    }
+}
+
+template <typename T>
+bool KineticEventScheduler<T>::contains(const size_t id) const
+{
+    return id < pos.size() && pos[id] != npos;
+}
+
+template <typename T>
+T KineticEventScheduler<T>::event_time(const size_t id) const
+{
+    return id < time.size() ? time[id] : inf;
+}
+
+template <typename T>
+bool KineticEventScheduler<T>::empty() const
+{
+    return heap.empty();
+}
+
+template <typename T>
+size_t KineticEventScheduler<T>::size() const
+{
+    return heap.size();
+}
+
+template <typename T>
+size_t KineticEventScheduler<T>::top() const
+{
+    return heap.front();
+}
+
+template <typename T>
+T KineticEventScheduler<T>::top_time() const
+{
+    return heap.empty() ? inf : time[heap.front()];
+}
+
+template <typename T>
+bool KineticEventScheduler<T>::pop(size_t &id, T &t)
+{
+    // the current time moves to the popped event, and the id leaves the queue until it is set again
+    if (heap.empty())
+    {
+        return false;
+    }
+    id = heap.front();
+    t = time[id];
+    current = t;
+    remove_at(0);
+    time[id] = inf;
+    return true;
+}
+
+template <typename T>
+T KineticEventScheduler<T>::now() const
+{
+    return current;
+}
+
+#ifdef QUADRATIC_EQUATION_SOLVER_EXTERN_TEMPLATE
+extern template class KineticEventScheduler<float>;
+extern template class KineticEventScheduler<double>;
+#endif
+
+#endif
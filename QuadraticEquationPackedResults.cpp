@@ -0,0 +1,5 @@
+// Explicit instantiations of the packed results for float and double, see QuadraticEquationSolver.cpp
+#include "QuadraticEquationPackedResults.h"
+
+template class PackedSolverResults<float>;
+template class PackedSolverResults<double>;
@@ -0,0 +1,327 @@
+#pragma once
+
+#ifndef _QUADRATIC_EQUATION_PACKED_RESULTS_
+#define _QUADRATIC_EQUATION_PACKED_RESULTS_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include "QuadraticEquationSolver.h"
+
+// Compact storage of many solver results.
+// Each state takes 1 byte, and only the roots which really exist are stored.
+// The NaN/Inf fillers returned by `solve` are rebuilt from the state when read back.
+template <typename T>
+class PackedSolverResults
+{
+public:
+    class const_iterator;
+
+    PackedSolverResults();
+    ~PackedSolverResults();
+    void push_back(const SolverState s, const T r1, const T r2);
+    void solve_push_back(const T a, const T b, const T c);
+    void solve_batch(const T *a, const T *b, const T *c, const size_t n);
+    void reserve(const size_t n);
+    void clear();
+    size_t size() const;
+    size_t root_count() const;
+    SolverState state(const size_t i) const;
+    SolverState get(const size_t i, T &r1, T &r2) const;
+    void unpack(SolverState *s, T *r1, T *r2) const;
+    const_iterator begin() const;
+    const_iterator end() const;
+    static constexpr std::uint8_t root_mask(const SolverState s);
+    static constexpr std::uint8_t has_root1 = 1;
+    static constexpr std::uint8_t has_root2 = 2;
+
+private:
+    // `states[i]` is the state code, `roots` holds the existing roots one by one,
+    // and `offsets[j]` is the index in `roots` of the first root of block j
+    std::vector<std::uint8_t> states;
+    std::vector<T> roots;
+    std::vector<size_t> offsets;
+    static constexpr size_t block_bit = 6;
+    static constexpr size_t block_size = size_t(1) << block_bit;
+    static constexpr int root_number(const std::uint8_t mask);
+    static void expand(const SolverState s, const T *p, T &r1, T &r2);
+    static constexpr T nan();
+    static constexpr T inf = std::numeric_limits<T>::infinity();
+};
+
+// Forward iterator which expands the results lazily, one by one.
+// The results are rebuilt on dereference, so `reference` is the value itself, not a real reference.
+template <typename T>
+class PackedSolverResults<T>::const_iterator
+{
+public:
+    struct value_type
+    {
+        SolverState state;
+        T x1;
+        T x2;
+    };
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    const_iterator();
+    const_iterator(const PackedSolverResults<T> *owner, const size_t i, const size_t k);
+    reference operator*() const;
+    const_iterator &operator++();
+    const_iterator operator++(int);
+    bool operator==(const const_iterator &other) const;
+    bool operator!=(const const_iterator &other) const;
+
+private:
+    const PackedSolverResults<T> *owner;
+    size_t i; // index of the result
+    size_t k; // index of its first root in `roots`
+};
+
+template <typename T>
+PackedSolverResults<T>::PackedSolverResults()
+{
+    static_assert(std::is_same_v<T, double> || std::is_same_v<T, float>, "Only support float or double type");
+}
+
+template <typename T>
+PackedSolverResults<T>::~PackedSolverResults()
+{
+}
+
+template <typename T>
+constexpr T PackedSolverResults<T>::nan()
+{
+    if (std::is_same_v<T, double>)
+    {
+        return static_cast<T>(std::nan(""));
+    }
+    else
+    {
+        return static_cast<T>(std::nanf(""));
+    }
+}
+
+template <typename T>
+constexpr std::uint8_t PackedSolverResults<T>::root_mask(const SolverState s)
+{
+    switch (s)
+    {
+    case ONE_REAL:
+        return has_root1;
+    case TWO_REAL:
+    case OVER_UNDER_FLOW:
+        // overflowed roots are kept as they are, since one of them may still be finite
+        return has_root1 | has_root2;
+    default:
+        return 0;
+    }
+}
+
+template <typename T>
+constexpr int PackedSolverResults<T>::root_number(const std::uint8_t mask)
+{
+    return (mask & has_root1) + ((mask & has_root2) >> 1);
+}
+
+template <typename T>
+void PackedSolverResults<T>::expand(const SolverState s, const T *p, T &r1, T &r2)
+{
+    // rebuild exactly what `QuadtraticEquationSolver::solve` returns
+    switch (s)
+    {
+    case ALL_REAL:
+        r1 = inf;
+        r2 = -inf;
+        return;
+    case NO_ROOT:
+        r1 = nan();
+        r2 = nan();
+        return;
+    case ONE_REAL:
+        r1 = p[0];
+        r2 = nan();
+        return;
+    case TWO_REAL:
+    case OVER_UNDER_FLOW:
+        r1 = p[0];
+        r2 = p[1];
+        return;
+    default:
+        r1 = 0;
+        r2 = 0;
+        return;
+    }
+}
+
+template <typename T>
+void PackedSolverResults<T>::push_back(const SolverState s, const T r1, const T r2)
+{
+    if ((states.size() & (block_size - 1)) == 0)
+    {
+        offsets.push_back(roots.size());
+    }
+    const std::uint8_t mask = root_mask(s);
+    states.push_back(static_cast<std::uint8_t>(s));
+    if (mask & has_root1)
+    {
+        roots.push_back(r1);
+    }
+    if (mask & has_root2)
+    {
+        roots.push_back(r2);
+    }
+}
+
+template <typename T>
+void PackedSolverResults<T>::solve_push_back(const T a, const T b, const T c)
+{
+    T r1(0), r2(0);
+    QuadtraticEquationSolver<T> solver(a, b, c);
+    const SolverState s = solver.solve(r1, r2);
+    push_back(s, r1, r2);
+}
+
+template <typename T>
+void PackedSolverResults<T>::solve_batch(const T *a, const T *b, const T *c, const size_t n)
+{
+    reserve(states.size() + n);
+    T r1(0), r2(0);
+    QuadtraticEquationSolver<T> solver(0, 0, 0);
+    for (size_t i = 0; i < n; ++i)
+    {
+        solver.reset(a[i], b[i], c[i]);
+        const SolverState s = solver.solve(r1, r2);
+        push_back(s, r1, r2);
+    }
+}
+
+template <typename T>
+void PackedSolverResults<T>::reserve(const size_t n)
+{
+    states.reserve(n);
+    offsets.reserve((n + block_size - 1) >> block_bit);
+}
+
+template <typename T>
+void PackedSolverResults<T>::clear()
+{
+    states.clear();
+    roots.clear();
+    offsets.clear();
+}
+
+template <typename T>
+size_t PackedSolverResults<T>::size() const
+{
+    return states.size();
+}
+
+template <typename T>
+size_t PackedSolverResults<T>::root_count() const
+{
+    return roots.size();
+}
+
+template <typename T>
+SolverState PackedSolverResults<T>::state(const size_t i) const
+{
+    return static_cast<SolverState>(states[i]);
+}
+
+template <typename T>
+SolverState PackedSolverResults<T>::get(const size_t i, T &r1, T &r2) const
+{
+    // start from the block offset, then count roots of the previous results in this block
+    size_t k = offsets[i >> block_bit];
+    for (size_t j = i & ~(block_size - 1); j < i; ++j)
+    {
+        k += root_number(root_mask(static_cast<SolverState>(states[j])));
+    }
+    const SolverState s = static_cast<SolverState>(states[i]);
+    expand(s, roots.data() + k, r1, r2);
+    return s;
+}
+
+template <typename T>
+void PackedSolverResults<T>::unpack(SolverState *s, T *r1, T *r2) const
+{
+    const T *p = roots.data();
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+        s[i] = static_cast<SolverState>(states[i]);
+        expand(s[i], p, r1[i], r2[i]);
+        p += root_number(root_mask(s[i]));
+    }
+}
+
+template <typename T>
+typename PackedSolverResults<T>::const_iterator PackedSolverResults<T>::begin() const
+{
+    return const_iterator(this, 0, 0);
+}
+
+template <typename T>
+typename PackedSolverResults<T>::const_iterator PackedSolverResults<T>::end() const
+{
+    return const_iterator(this, states.size(), roots.size());
+}
+
+template <typename T>
+PackedSolverResults<T>::const_iterator::const_iterator()
+    : owner(nullptr), i(0), k(0)
+{
+}
+
+template <typename T>
+PackedSolverResults<T>::const_iterator::const_iterator(const PackedSolverResults<T> *owner, const size_t i, const size_t k)
+    : owner(owner), i(i), k(k)
+{
+}
+
+template <typename T>
+typename PackedSolverResults<T>::const_iterator::reference PackedSolverResults<T>::const_iterator::operator*() const
+{
+    value_type v;
+    v.state = static_cast<SolverState>(owner->states[i]);
+    expand(v.state, owner->roots.data() + k, v.x1, v.x2);
+    return v;
+}
+
+template <typename T>
+typename PackedSolverResults<T>::const_iterator &PackedSolverResults<T>::const_iterator::operator++()
+{
+    k += root_number(root_mask(static_cast<SolverState>(owner->states[i])));
+    ++i;
+    return *this;
+}
+
+template <typename T>
+typename PackedSolverResults<T>::const_iterator PackedSolverResults<T>::const_iterator::operator++(int)
+{
+    const_iterator old = *this;
+    ++*this;
+    return old;
+}
+
+template <typename T>
+bool PackedSolverResults<T>::const_iterator::operator==(const const_iterator &other) const
+{
+    return owner == other.owner && i == other.i;
+}
+
+template <typename T>
+bool PackedSolverResults<T>::const_iterator::operator!=(const const_iterator &other) const
+{
+    return !(*this == other);
+}
+
+#ifdef QUADRATIC_EQUATION_SOLVER_EXTERN_TEMPLATE
+extern template class PackedSolverResults<float>;
+extern template class PackedSolverResults<double>;
+#endif
+
+#endif
@@ -0,0 +1,5 @@
+// Explicit instantiations of the root tracker for float and double, see QuadraticEquationSolver.cpp
+#include "QuadraticEquationRootTracker.h"
+
+template class QuadraticRootTracker<float>;
+template class QuadraticRootTracker<double>;
@@ -0,0 +1,189 @@
+#pragma once
+
+#ifndef _QUADRATIC_EQUATION_ROOT_TRACKER_
+#define _QUADRATIC_EQUATION_ROOT_TRACKER_
+
+#include <cstddef>
+#include "QuadraticEquationSolver.h"
+
+// Root tracking for coefficients which change slightly from one call to the next.
+// When the last result has two real roots, each of them is refined by guarded Newton steps, usually one or two and at most `max_newton`,
+// on the new coefficients, instead of the full robust solve.
+// The robust solve is only called when a guard fails, which includes:
+// 1. the last result is not two real roots, or a, b or c becomes zero;
+// 2. the Newton steps are too large compared with the gap of the roots (roots merge, disappear or cross);
+// 3. a * x^2, b * x or c is out of the normal range (where the robust solver would scale the exponents);
+// 4. the error bound of the refined root exceeds 1 ULP, where f(x) is evaluated by compensated Horner scheme.
+// The tracked roots stay within `ulp_bound` ULP of a fresh `solve` with the same state.
+template <typename T>
+class QuadraticRootTracker
+{
+public:
+    QuadraticRootTracker();
+    ~QuadraticRootTracker();
+    SolverState track(const T a, const T b, const T c, T &r1, T &r2);
+    void reset();
+    size_t newton_count() const;
+    size_t solve_count() const;
+    static constexpr int ulp_bound = 4;
+    static constexpr int max_newton = 3;
+
+private:
+    QuadtraticEquationSolver<T> solver;
+    T x1;
+    T x2;
+    SolverState state;
+    size_t n_newton;
+    size_t n_solve;
+    static constexpr T eps = std::numeric_limits<T>::epsilon();
+    static constexpr T tiny = std::numeric_limits<T>::min() / (eps * eps);
+    static constexpr T huge = std::numeric_limits<T>::max() * eps;
+    static void two_sum(const T x, const T y, T &s, T &e);
+    static T compensated_horner(const T a, const T b, const T c, const T x);
+    static bool refine(const T a, const T b, const T c, const T gap, T &x);
+    bool try_newton(const T a, const T b, const T c);
+};
+
+template <typename T>
+QuadraticRootTracker<T>::QuadraticRootTracker()
+    : solver(0, 0, 0), x1(0), x2(0), state(UNCERTAIN), n_newton(0), n_solve(0)
+{
+}
+
+template <typename T>
+QuadraticRootTracker<T>::~QuadraticRootTracker()
+{
+}
+
+template <typename T>
+void QuadraticRootTracker<T>::two_sum(const T x, const T y, T &s, T &e)
+{
+    s = x + y;
+    const T z = s - x;
+    e = (x - (s - z)) + (y - z);
+}
+
+template <typename T>
+T QuadraticRootTracker<T>::compensated_horner(const T a, const T b, const T c, const T x)
+{
+    // a * x^2 + b * x + c with the rounding errors of every step added back,
+    // so the result is as accurate as evaluated in twice the working precision
+    T e1, e2, e3, e4;
+    const T p1 = a * x;
+    e1 = QuadtraticEquationSolver<T>::exactmult(a, x, p1);
+    T s1;
+    two_sum(p1, b, s1, e2);
+    const T p2 = s1 * x;
+    e3 = QuadtraticEquationSolver<T>::exactmult(s1, x, p2);
+    T s2;
+    two_sum(p2, c, s2, e4);
+    return s2 + (((e1 + e2) * x + e3) + e4);
+}
+
+template <typename T>
+bool QuadraticRootTracker<T>::refine(const T a, const T b, const T c, const T gap, T &x)
+{
+    constexpr T two = 2;
+    constexpr T eight = 8;
+    const T ax = std::fabs(a * x);
+    const T axx = std::fabs(a * x * x);
+    const T bx = std::fabs(b * x);
+    const T cx = std::fabs(c);
+    if (!(std::fmax(std::fmax(ax, axx), std::fmax(bx, cx)) < huge) || std::fabs(x) >= huge ||
+        std::fabs(a) >= huge || std::fabs(b) >= huge ||
+        ax < tiny || axx < tiny || bx < tiny || cx < tiny)
+    {
+        return false;
+    }
+    const T s = axx + bx + cx;
+    for (int i = 0; i < max_newton; ++i)
+    {
+        const T f = compensated_horner(a, b, c, x);
+        const T d = two * a * x + b;
+        const T dx = f / d;
+        if (i == 0 && !(std::fabs(dx) < gap / 16))
+        {
+            return false; // far from the last root, Newton may converge to the other root or not at all
+        }
+        x -= dx;
+        // error bound of the new root: the Newton remainder of this step,
+        // plus the evaluation error of f, divided by |f'(x)|
+        const T bound = (std::fabs(a) * dx * dx + eps * std::fabs(f) + eight * eps * eps * s) / std::fabs(d);
+        if (bound <= eps * std::fabs(x))
+        {
+            return std::isfinite(x) && x != 0;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+bool QuadraticRootTracker<T>::try_newton(const T a, const T b, const T c)
+{
+    if (TWO_REAL != state || a == 0 || b == 0 || c == 0 || !std::isfinite(a) || !std::isfinite(b) || !std::isfinite(c))
+    {
+        return false;
+    }
+    const T gap = x2 - x1;
+    T y1 = x1, y2 = x2;
+    if (!(gap > 0) || !refine(a, b, c, gap, y1) || !refine(a, b, c, gap, y2))
+    {
+        return false;
+    }
+    // the slopes at two distinct roots have opposite signs, otherwise the roots have crossed or merged
+    constexpr T two = 2;
+    const T d1 = two * a * y1 + b;
+    const T d2 = two * a * y2 + b;
+    if (!(y1 < y2) || !((d1 < 0 && d2 > 0 && a > 0) || (d1 > 0 && d2 < 0 && a < 0)))
+    {
+        return false;
+    }
+    x1 = y1;
+    x2 = y2;
+    return true;
+}
+
+template <typename T>
+SolverState QuadraticRootTracker<T>::track(const T a, const T b, const T c, T &r1, T &r2)
+{
+    if (try_newton(a, b, c))
+    {
+        ++n_newton;
+    }
+    else
+    {
+        ++n_solve;
+        solver.reset(a, b, c);
+        state = solver.solve(x1, x2);
+    }
+    r1 = x1;
+    r2 = x2;
+    return state;
+}
+
+template <typename T>
+void QuadraticRootTracker<T>::reset()
+{
+    state = UNCERTAIN;
+    x1 = 0;
+    x2 = 0;
+}
+
+template <typename T>
+size_t QuadraticRootTracker<T>::newton_count() const
+{
+    return n_newton;
+}
+
+template <typename T>
+size_t QuadraticRootTracker<T>::solve_count() const
+{
+    return n_solve;
+}
+
+#ifdef QUADRATIC_EQUATION_SOLVER_EXTERN_TEMPLATE
+extern template class QuadraticRootTracker<float>;
+extern template class QuadraticRootTracker<double>;
+#endif
+
+#endif
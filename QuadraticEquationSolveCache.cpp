@@ -0,0 +1,5 @@
+// Explicit instantiations of the solve cache for float and double, see QuadraticEquationSolver.cpp
+#include "QuadraticEquationSolveCache.h"
+
+template class QuadraticSolveCache<float>;
+template class QuadraticSolveCache<double>;
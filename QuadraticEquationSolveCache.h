@@ -0,0 +1,268 @@
+#pragma once
+
+#ifndef _QUADRATIC_EQUATION_SOLVE_CACHE_
+#define _QUADRATIC_EQUATION_SOLVE_CACHE_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "QuadraticEquationSolver.h"
+#include "QuadraticEquationPackedResults.h"
+
+// Memoizing cache in front of the solver, for coefficient triples which repeat a lot.
+// It is a fixed capacity open addressing table keyed on the bit patterns of a, b and c,
+// so -0 and 0, or NaNs with different payloads, are different keys.
+// Every slot is guarded by a sequence lock: reads are lock-free and never wait,
+// and a write is simply skipped when another thread is writing the same slot.
+// The returned roots and state are exactly the same as an uncached `solve`.
+template <typename T>
+class QuadraticSolveCache
+{
+public:
+    QuadraticSolveCache(const size_t capacity = size_t(1) << 16);
+    ~QuadraticSolveCache();
+    SolverState solve(const T a, const T b, const T c, T &r1, T &r2);
+    void solve_batch(const T *a, const T *b, const T *c, const size_t n, SolverState *s, T *r1, T *r2);
+    void solve_batch(const T *a, const T *b, const T *c, const size_t n, PackedSolverResults<T> &out);
+    void clear();
+    size_t capacity() const;
+    size_t hits() const;
+    size_t misses() const;
+
+private:
+    using B = std::conditional_t<std::is_same_v<T, double>, std::uint64_t, std::uint32_t>;
+    struct Slot
+    {
+        std::atomic<std::uint32_t> seq; // odd while being written
+        std::atomic<std::uint32_t> state;
+        std::atomic<B> a;
+        std::atomic<B> b;
+        std::atomic<B> c;
+        std::atomic<B> r1;
+        std::atomic<B> r2;
+    };
+    // hit and miss counters, one cache line per shard and each thread counts in its own shard,
+    // so counting does not bounce a shared line between the threads, nor the line of `slots` and `mask`
+    struct alignas(64) Counter
+    {
+        std::atomic<size_t> hit;
+        std::atomic<size_t> miss;
+    };
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+    static constexpr size_t n_shard = 16;
+    Counter counters[n_shard];
+    static constexpr size_t max_probe = 8;
+    static size_t shard();
+    static size_t hash(const B a, const B b, const B c);
+    bool lookup(const size_t h, const B a, const B b, const B c, SolverState &s, T &r1, T &r2) const;
+    void insert(const size_t h, const B a, const B b, const B c, const SolverState s, const T r1, const T r2);
+};
+
+template <typename T>
+QuadraticSolveCache<T>::QuadraticSolveCache(const size_t capacity)
+{
+    static_assert(std::is_same_v<T, double> || std::is_same_v<T, float>, "Only support float or double type");
+    size_t n = max_probe;
+    while (n < capacity)
+    {
+        n <<= 1;
+    }
+    slots.reset(new Slot[n]);
+    mask = n - 1;
+    clear();
+}
+
+template <typename T>
+QuadraticSolveCache<T>::~QuadraticSolveCache()
+{
+}
+
+template <typename T>
+size_t QuadraticSolveCache<T>::hash(const B a, const B b, const B c)
+{
+    // splitmix64 finalizer over the combined bits
+    std::uint64_t h = static_cast<std::uint64_t>(a);
+    h = h * 0x9E3779B97F4A7C15ull + static_cast<std::uint64_t>(b);
+    h = h * 0x9E3779B97F4A7C15ull + static_cast<std::uint64_t>(c);
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ull;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBull;
+    h ^= h >> 31;
+    return static_cast<size_t>(h);
+}
+
+template <typename T>
+size_t QuadraticSolveCache<T>::shard()
+{
+    // threads take the shards in turn when they first count
+    static std::atomic<size_t> next(0);
+    thread_local const size_t id = next.fetch_add(1, std::memory_order_relaxed) & (n_shard - 1);
+    return id;
+}
+
+template <typename T>
+bool QuadraticSolveCache<T>::lookup(const size_t h, const B a, const B b, const B c, SolverState &s, T &r1, T &r2) const
+{
+    for (size_t i = 0; i < max_probe; ++i)
+    {
+        const Slot &slot = slots[(h + i) & mask];
+        const std::uint32_t seq = slot.seq.load(std::memory_order_acquire);
+        if (seq & 1)
+        {
+            continue; // being written, treat as a different key
+        }
+        const std::uint32_t st = slot.state.load(std::memory_order_relaxed);
+        const B ka = slot.a.load(std::memory_order_relaxed);
+        const B kb = slot.b.load(std::memory_order_relaxed);
+        const B kc = slot.c.load(std::memory_order_relaxed);
+        const B x1 = slot.r1.load(std::memory_order_relaxed);
+        const B x2 = slot.r2.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != seq)
+        {
+            continue;
+        }
+        if (UNCERTAIN == st)
+        {
+            return false; // empty slot, and slots are never emptied again, so the key is not in a later one
+        }
+        if (ka == a && kb == b && kc == c)
+        {
+            s = static_cast<SolverState>(st);
+            r1 = std::bit_cast<T>(x1);
+            r2 = std::bit_cast<T>(x2);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+void QuadraticSolveCache<T>::insert(const size_t h, const B a, const B b, const B c, const SolverState s, const T r1, const T r2)
+{
+    // take the first empty slot, otherwise replace the home slot
+    Slot *target = &slots[h & mask];
+    for (size_t i = 0; i < max_probe; ++i)
+    {
+        Slot &slot = slots[(h + i) & mask];
+        if (UNCERTAIN == slot.state.load(std::memory_order_relaxed))
+        {
+            target = &slot;
+            break;
+        }
+    }
+    std::uint32_t seq = target->seq.load(std::memory_order_relaxed);
+    if ((seq & 1) || !target->seq.compare_exchange_strong(seq, seq + 1, std::memory_order_relaxed))
+    {
+        return; // another thread is writing this slot
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    target->state.store(static_cast<std::uint32_t>(s), std::memory_order_relaxed);
+    target->a.store(a, std::memory_order_relaxed);
+    target->b.store(b, std::memory_order_relaxed);
+    target->c.store(c, std::memory_order_relaxed);
+    target->r1.store(std::bit_cast<B>(r1), std::memory_order_relaxed);
+    target->r2.store(std::bit_cast<B>(r2), std::memory_order_relaxed);
+    target->seq.store(seq + 2, std::memory_order_release);
+}
+
+template <typename T>
+SolverState QuadraticSolveCache<T>::solve(const T a, const T b, const T c, T &r1, T &r2)
+{
+    const B ka = std::bit_cast<B>(a);
+    const B kb = std::bit_cast<B>(b);
+    const B kc = std::bit_cast<B>(c);
+    const size_t h = hash(ka, kb, kc);
+    SolverState s(UNCERTAIN);
+    Counter &counter = counters[shard()];
+    if (lookup(h, ka, kb, kc, s, r1, r2))
+    {
+        counter.hit.fetch_add(1, std::memory_order_relaxed);
+        return s;
+    }
+    counter.miss.fetch_add(1, std::memory_order_relaxed);
+    QuadtraticEquationSolver<T> solver(a, b, c);
+    s = solver.solve(r1, r2);
+    insert(h, ka, kb, kc, s, r1, r2);
+    return s;
+}
+
+template <typename T>
+void QuadraticSolveCache<T>::solve_batch(const T *a, const T *b, const T *c, const size_t n, SolverState *s, T *r1, T *r2)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        s[i] = solve(a[i], b[i], c[i], r1[i], r2[i]);
+    }
+}
+
+template <typename T>
+void QuadraticSolveCache<T>::solve_batch(const T *a, const T *b, const T *c, const size_t n, PackedSolverResults<T> &out)
+{
+    out.reserve(out.size() + n);
+    T r1(0), r2(0);
+    for (size_t i = 0; i < n; ++i)
+    {
+        const SolverState s = solve(a[i], b[i], c[i], r1, r2);
+        out.push_back(s, r1, r2);
+    }
+}
+
+template <typename T>
+void QuadraticSolveCache<T>::clear()
+{
+    // not thread-safe, must not run together with `solve`
+    for (size_t i = 0; i <= mask; ++i)
+    {
+        slots[i].seq.store(0, std::memory_order_relaxed);
+        slots[i].state.store(UNCERTAIN, std::memory_order_relaxed);
+        slots[i].a.store(0, std::memory_order_relaxed);
+        slots[i].b.store(0, std::memory_order_relaxed);
+        slots[i].c.store(0, std::memory_order_relaxed);
+        slots[i].r1.store(0, std::memory_order_relaxed);
+        slots[i].r2.store(0, std::memory_order_relaxed);
+    }
+    for (Counter &counter : counters)
+    {
+        counter.hit.store(0, std::memory_order_relaxed);
+        counter.miss.store(0, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+size_t QuadraticSolveCache<T>::capacity() const
+{
+    return mask + 1;
+}
+
+template <typename T>
+size_t QuadraticSolveCache<T>::hits() const
+{
+    size_t n = 0;
+    for (const Counter &counter : counters)
+    {
+        n += counter.hit.load(std::memory_order_relaxed);
+    }
+    return n;
+}
+
+template <typename T>
+size_t QuadraticSolveCache<T>::misses() const
+{
+    size_t n = 0;
+    for (const Counter &counter : counters)
+    {
+        n += counter.miss.load(std::memory_order_relaxed);
+    }
+    return n;
+}
+
+#ifdef QUADRATIC_EQUATION_SOLVER_EXTERN_TEMPLATE
+extern template class QuadraticSolveCache<float>;
+extern template class QuadraticSolveCache<double>;
+#endif
+
+#endif
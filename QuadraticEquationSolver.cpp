@@ -0,0 +1,8 @@
+// Explicit instantiations of the solver for float and double.
+// Link the quadratic_solver library and define QUADRATIC_EQUATION_SOLVER_EXTERN_TEMPLATE,
+// then other translation units only declare them by `extern template`, instead of instantiating them again.
+// Every header has its own translation unit, so a program only links the tools it uses.
+#include "QuadraticEquationSolver.h"
+
+template class QuadtraticEquationSolver<float>;
+template class QuadtraticEquationSolver<double>;
@@ -5,7 +5,13 @@
 
 #include <limits>
 #include <cmath>
+#include <string>
+#include <cstdint>
+#include <bit>
 #include <type_traits>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
 
 #define sign(x) (((x) < 0) ? (-1) : (1))
 #define is_invalid_input(x) ((std::isnan((x))) || (std::isinf((x))))
@@ -21,13 +27,19 @@ enum SolverState
     OVER_UNDER_FLOW
 };
 
+template <typename T>
+class QuadraticRootTracker;
+
 template <typename T>
 class QuadtraticEquationSolver
 {
+    friend class QuadraticRootTracker<T>;
+
 public:
     QuadtraticEquationSolver(const T a, const T b, const T c);
     ~QuadtraticEquationSolver();
     SolverState solve(T &r1, T &r2);
+    SolverState solve_branchless(T &r1, T &r2);
     void reset(const T a, const T b, const T c);
     static const std::string print_solver_state(SolverState s);
     const std::string print_solver_state();
@@ -55,6 +67,13 @@ private:
     void solve_axx_plus_c();
     void solve_axx_plus_bx();
     void solve_complete();
+    template <typename U>
+    static U select(const bool m, const U x, const U y);
+    static void keep_exponent_branchless(const int m, int &m1, int &m2);
+    static T pow2_branchless(const int k);
+    static T frexp_branchless(const T x, int &e);
+    static T sqrt_branchless(const T x);
+    static T kahan_discriminant_branchless(const T a, const T b, const T c);
     static constexpr T inf = std::numeric_limits<T>::infinity();
     static constexpr int n_bit_e = std::is_same_v<T, double> ? 11 : 8;
     static constexpr int n_bit_f = std::is_same_v<T, double> ? 52 : 23;
@@ -393,6 +412,204 @@ SolverState QuadtraticEquationSolver<T>::solve(T &r1, T &r2)
     return state;
 }
 
+template <typename T>
+template <typename U>
+U QuadtraticEquationSolver<T>::select(const bool m, const U x, const U y)
+{
+    // m ? x : y by bit masks, so no branch depends on m
+    using B = std::conditional_t<sizeof(U) == 8, std::uint64_t, std::uint32_t>;
+    static_assert(sizeof(U) == sizeof(B), "Only support 32 or 64 bits type");
+    B mask = static_cast<B>(0) - static_cast<B>(m);
+#if defined(__GNUC__) || defined(__clang__)
+    // hide where the mask comes from, otherwise the optimizer may turn it back into a branch
+    __asm__("" : "+r"(mask));
+#endif
+    return std::bit_cast<U>(static_cast<B>((std::bit_cast<B>(x) & mask) | (std::bit_cast<B>(y) & ~mask)));
+}
+
+template <typename T>
+void QuadtraticEquationSolver<T>::keep_exponent_branchless(const int m, int &m1, int &m2)
+{
+    m1 = select(m < m_min, m_min, select(m > m_max, m_max, m));
+    m2 = m - m1;
+}
+
+template <typename T>
+T QuadtraticEquationSolver<T>::pow2_branchless(const int k)
+{
+    // 2^k as the product of two normal powers of 2 built from bits,
+    // which is rounded the same as std::pow(2, k), including subnormal, underflow and overflow
+    using B = std::conditional_t<std::is_same_v<T, double>, std::uint64_t, std::uint32_t>;
+    int k1, k2;
+    keep_exponent_branchless(k, k1, k2);
+    k2 = select(k2 < m_min, m_min, select(k2 > m_max, m_max, k2));
+    const T p1 = std::bit_cast<T>(static_cast<B>(static_cast<B>(k1 + m_max) << n_bit_f));
+    const T p2 = std::bit_cast<T>(static_cast<B>(static_cast<B>(k2 + m_max) << n_bit_f));
+    return p1 * p2;
+}
+
+template <typename T>
+T QuadtraticEquationSolver<T>::frexp_branchless(const T x, int &e)
+{
+    // the same as frexp for finite x, only by integer operations on the bits,
+    // where the fraction of subnormal x is normalized by counting its leading zeros
+    using B = std::conditional_t<std::is_same_v<T, double>, std::uint64_t, std::uint32_t>;
+    constexpr B f_mask = (static_cast<B>(1) << n_bit_f) - 1;
+    constexpr B e_mask = ((static_cast<B>(1) << n_bit_e) - 1) << n_bit_f;
+    const B bits = std::bit_cast<B>(x);
+    const B frac = bits & f_mask;
+    const int biased = static_cast<int>((bits & e_mask) >> n_bit_f);
+    const bool sub = biased == 0;
+    const int shift = std::countl_zero(static_cast<B>(frac | 1)) - n_bit_e; // the low bit keeps it defined when frac is 0
+    const B norm = select(sub, static_cast<B>((frac << shift) & f_mask), frac);
+    const B f = (bits & ~(e_mask | f_mask)) | (static_cast<B>(m_max - 1) << n_bit_f) | norm;
+    const bool zero = sub & (frac == 0);
+    e = select(zero, 0, select(sub, 1 - shift, biased) - (m_max - 1));
+    return select(zero, x, std::bit_cast<T>(f));
+}
+
+template <typename T>
+T QuadtraticEquationSolver<T>::sqrt_branchless(const T x)
+{
+    // negative or NaN x only comes from the paths not selected, and is clamped to 0,
+    // so std::sqrt never takes its errno path, and SSE computes it without that check at all
+    const T y = select(x >= 0, x, static_cast<T>(0));
+#if defined(__SSE2__) || defined(_M_X64)
+    if constexpr (std::is_same_v<T, double>)
+    {
+        return _mm_cvtsd_f64(_mm_sqrt_sd(_mm_setzero_pd(), _mm_set_sd(y)));
+    }
+    else
+    {
+        return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(y)));
+    }
+#else
+    return std::sqrt(y);
+#endif
+}
+
+template <typename T>
+T QuadtraticEquationSolver<T>::kahan_discriminant_branchless(const T a, const T b, const T c)
+{
+    constexpr T th = 3;
+    constexpr T four = 4;
+    T p = b * b;
+    T q = four * a * c;
+    T d = p - q;
+    T dp = exactmult(b, b, p);
+    T dq = exactmult(four * a, c, q);
+    return select(th * std::fabs(d) >= (p + q), d, d + (dp - dq));
+}
+
+template <typename T>
+SolverState QuadtraticEquationSolver<T>::solve_branchless(T &r1, T &r2)
+{
+    // Same results as `solve`, but every path is computed and the result is selected by masks,
+    // so the latency does not depend on the input.
+    // frexp, pow and sqrt are replaced by versions without branches.
+    // The paths not selected run on harmless values (ratio 1, exponent 0),
+    // so they never produce subnormal or overflowing numbers, which are slow on some CPUs.
+    constexpr T two = 2;
+    constexpr T zero = 0;
+    constexpr T one = 1;
+    const T qnan = nan();
+    const bool valid = std::isfinite(a) & std::isfinite(b) & std::isfinite(c);
+    const bool a0 = a == 0;
+    const bool b0 = b == 0;
+    const bool c0 = c == 0;
+    const bool use_lin = valid & a0;
+    const bool use_ac = valid & !a0 & b0;
+    const bool use_ab = valid & !a0 & !b0 & c0;
+    const bool use_full = valid & !a0 & !b0 & !c0;
+
+    // bx + c = 0
+    const T lin = select(c0, zero, -select(use_lin, c, one) / select(use_lin, b, one));
+    const SolverState s_lin = select(b0, select(c0, ALL_REAL, NO_ROOT), ONE_REAL);
+    const T x1_lin = select(b0, select(c0, inf, qnan), lin);
+    const T x2_lin = select(b0, select(c0, -inf, qnan), qnan);
+
+    int ea, eb, ec;
+    const T a2 = select(valid & !a0, frexp_branchless(a, ea), one);
+    const T b2 = select(valid & !b0, frexp_branchless(b, eb), one);
+    const T c2 = select(valid & !c0, frexp_branchless(c, ec), one);
+
+    // ax^2 + c = 0
+    const bool same_ac = (a < 0) == (c < 0);
+    const int ecp_ac = ec - ea;
+    int m1, m2;
+    keep_exponent_branchless(select(use_ac, (ecp_ac & (~1)) >> 1, 0), m1, m2);
+    const T c3_ac = c2 * pow2_branchless(ecp_ac & 1);
+    const T x_ac = (sqrt_branchless(-c3_ac / a2) * pow2_branchless(m2)) * pow2_branchless(m1);
+    const SolverState s_ac = select(c0, ONE_REAL, select(same_ac, NO_ROOT, TWO_REAL));
+    const T x1_ac = select(c0, zero, select(same_ac, qnan, -x_ac));
+    const T x2_ac = select(c0 | same_ac, qnan, x_ac);
+
+    // ax^2 + bx = 0
+    const bool same_ab = (a < 0) == (b < 0);
+    const T x_ab = -select(use_ab, b, one) / select(use_ab, a, one);
+    const T x1_ab = select(same_ab, x_ab, zero);
+    const T x2_ab = select(same_ab, zero, x_ab);
+
+    // ax^2 + bx + c = 0
+    constexpr int e_min = m_min + 2 * n_bit_f - 4;
+    constexpr int e_max = m_max - 2 - (n_bit_f >> 1);
+    const int k = eb - ea;
+    const int ecp = ec + ea - 2 * eb;
+    const bool low = ecp < e_min;
+    const bool high = !low & !(ecp < e_max);
+    const bool use_mid = use_full & !low & !high;
+    const bool use_low = use_full & low;
+    const bool use_high = use_full & high;
+    int k1, k2;
+    // common exponent range
+    keep_exponent_branchless(select(use_mid, k, 0), k1, k2);
+    T pk1 = pow2_branchless(k1);
+    T pk2 = pow2_branchless(k2);
+    const T cp = c2 * pow2_branchless(select(use_mid, ecp, 0));
+    const T delta = kahan_discriminant_branchless(a2, b2, cp);
+    const T sq = sqrt_branchless(delta);
+    const T bsq = b2 + std::copysign(sq, b); // sign(b) * sq without the branch in `sign`
+    const T y1 = ((-(two * cp) / bsq) * pk2) * pk1;
+    const T y2 = ((-bsq / (two * a2)) * pk2) * pk1;
+    const T y0 = ((-b2 / (two * a2)) * pk2) * pk1;
+    const bool y_sorted = y1 < y2;
+    const SolverState s_mid = select(delta < 0, NO_ROOT, select(delta > 0, TWO_REAL, ONE_REAL));
+    const T x1_mid = select(delta < 0, qnan, select(delta > 0, select(y_sorted, y1, y2), y0));
+    const T x2_mid = select(delta < 0, qnan, select(delta > 0, select(y_sorted, y2, y1), qnan));
+    // c is too small
+    const int dm = ecp & (~1);
+    const T c3 = c2 * pow2_branchless(ecp & 1);
+    const T z1 = -b2 / a2;
+    const T z2 = c3 / (a2 * z1);
+    keep_exponent_branchless(select(use_low, k, 0), k1, k2);
+    pk1 = pow2_branchless(k1);
+    pk2 = pow2_branchless(k2);
+    int dm1, dm2;
+    keep_exponent_branchless(select(use_low, dm + k, 0), dm1, dm2);
+    const T w1 = (z1 * pk2) * pk1;
+    const T w2 = (z2 * pow2_branchless(dm2)) * pow2_branchless(dm1);
+    const bool w_sorted = w1 < w2;
+    // c is too large
+    keep_exponent_branchless(select(use_high, (dm >> 1) + k, 0), dm1, dm2);
+    const T v = (sqrt_branchless(std::fabs(c3 / a2)) * pow2_branchless(dm2)) * pow2_branchless(dm1);
+    const SolverState s_full = select(low, TWO_REAL, select(high, select(same_ac, NO_ROOT, TWO_REAL), s_mid));
+    const T x1_full = select(low, select(w_sorted, w1, w2), select(high, select(same_ac, qnan, -v), x1_mid));
+    const T x2_full = select(low, select(w_sorted, w2, w1), select(high, select(same_ac, qnan, v), x2_mid));
+
+    // the same order of cases as `solve`
+    SolverState s = select(b0, s_ac, select(c0, TWO_REAL, s_full));
+    T y = select(b0, x1_ac, select(c0, x1_ab, x1_full));
+    T z = select(b0, x2_ac, select(c0, x2_ab, x2_full));
+    s = select(valid, select(a0, s_lin, s), INVALID_INPUT);
+    x1 = select(valid, select(a0, x1_lin, y), x1);
+    x2 = select(valid, select(a0, x2_lin, z), x2);
+    const bool flow = ((TWO_REAL == s) & (!std::isfinite(x1) | !std::isfinite(x2))) | ((ONE_REAL == s) & !std::isfinite(x1));
+    state = select(flow, OVER_UNDER_FLOW, s);
+    r1 = x1;
+    r2 = x2;
+    return state;
+}
+
 template <typename T>
 void QuadtraticEquationSolver<T>::reset(const T a, const T b, const T c)
 {
@@ -433,6 +650,12 @@ const std::string QuadtraticEquationSolver<T>::print_solver_state()
     return QuadtraticEquationSolver<T>::print_solver_state(this->state);
 }
 
+#ifdef QUADRATIC_EQUATION_SOLVER_EXTERN_TEMPLATE
+// instantiated once in the quadratic_solver library, see QuadraticEquationSolver.cpp
+extern template class QuadtraticEquationSolver<float>;
+extern template class QuadtraticEquationSolver<double>;
+#endif
+
 #undef sign
 #undef is_invalid_input
 
@@ -0,0 +1,71 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "QuadraticEquationKineticScheduler.h"
+
+// Crossing time prediction of a million moving pairs.
+// When an event happens, the involved objects change their motion,
+// so the popped pair and a few other pairs sharing these objects are solved again.
+int main(int argc, char **argv)
+{
+    const size_t n_pair = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    const size_t n_event = argc > 2 ? std::stoul(argv[2]) : 1000000;
+    constexpr size_t n_affected = 8;
+    std::mt19937_64 gen(2025);
+    std::uniform_real_distribution<double> u(-1, 1);
+    std::uniform_int_distribution<size_t> pick(0, n_pair - 1);
+    KineticEventScheduler<double> scheduler;
+
+    // relative distance d(t) = p + v * (t - t0) + g / 2 * (t - t0)^2, in absolute time t
+    auto motion = [&](const double t0, double &a, double &b, double &c)
+    {
+        const double p = 100 * u(gen);
+        const double v = 10 * u(gen);
+        const double g = u(gen);
+        a = g / 2;
+        b = v - g * t0;
+        c = p - v * t0 + g / 2 * t0 * t0;
+    };
+
+    std::vector<size_t> ids(n_pair);
+    std::vector<double> a(n_pair), b(n_pair), c(n_pair);
+    for (size_t i = 0; i < n_pair; ++i)
+    {
+        ids[i] = i;
+        motion(0, a[i], b[i], c[i]);
+    }
+    auto start = std::chrono::steady_clock::now();
+    scheduler.set_batch(ids.data(), a.data(), b.data(), c.data(), n_pair);
+    auto stop = std::chrono::steady_clock::now();
+    const double t_build = std::chrono::duration<double>(stop - start).count();
+    std::cout << "Pairs: " << n_pair << ", active events: " << scheduler.size() << std::endl;
+    std::cout << "Initial batch solve: " << t_build << " s, "
+              << n_pair / t_build << " equations/s" << std::endl;
+
+    size_t id = 0, n_done = 0, n_solved = 0;
+    double t = 0;
+    std::vector<size_t> affected(n_affected);
+    std::vector<double> aa(n_affected), ab(n_affected), ac(n_affected);
+    start = std::chrono::steady_clock::now();
+    while (n_done < n_event && scheduler.pop(id, t))
+    {
+        affected[0] = id;
+        for (size_t j = 1; j < n_affected; ++j)
+        {
+            affected[j] = pick(gen);
+        }
+        for (size_t j = 0; j < n_affected; ++j)
+        {
+            motion(t, aa[j], ab[j], ac[j]);
+        }
+        scheduler.set_batch(affected.data(), aa.data(), ab.data(), ac.data(), n_affected);
+        n_solved += n_affected;
+        ++n_done;
+    }
+    stop = std::chrono::steady_clock::now();
+    const double t_run = std::chrono::duration<double>(stop - start).count();
+    std::cout << "Events processed: " << n_done << " in " << t_run << " s, simulated time " << t << std::endl;
+    std::cout << "Events/s: " << n_done / t_run << ", re-solved equations/s: " << n_solved / t_run << std::endl;
+    return 0;
+}
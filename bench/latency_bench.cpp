@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include "QuadraticEquationSolver.h"
+
+// Per-call latency distribution of `solve` and `solve_branchless`.
+// Most equations take the common path, and a small part of them takes the slow or rare paths
+// (exponents out of the common range, Kahan correction, zero coefficients).
+// Then every input class is timed on its own, where a constant latency solver should show the same numbers for all of them.
+template <typename F>
+std::vector<double> measure(const std::vector<double> &a, const std::vector<double> &b, const std::vector<double> &c, F f)
+{
+    std::vector<double> ns(a.size());
+    double sink = 0;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        double x1 = 0, x2 = 0;
+        QuadtraticEquationSolver<double> solver(a[i], b[i], c[i]);
+        const auto start = std::chrono::steady_clock::now();
+        const SolverState s = f(solver, x1, x2);
+        const auto stop = std::chrono::steady_clock::now();
+        sink += x1 + x2 + static_cast<double>(s);
+        ns[i] = std::chrono::duration<double, std::nano>(stop - start).count();
+    }
+    volatile double keep = sink;
+    (void)keep;
+    return ns;
+}
+
+void report(const std::string &name, std::vector<double> ns, const double overhead)
+{
+    std::sort(ns.begin(), ns.end());
+    auto at = [&](const double p)
+    {
+        return std::max(0., ns[static_cast<size_t>(p * static_cast<double>(ns.size() - 1))] - overhead);
+    };
+    double mean = 0;
+    for (const double t : ns)
+    {
+        mean += t;
+    }
+    mean = std::max(0., mean / static_cast<double>(ns.size()) - overhead);
+    std::cout << std::left << std::setw(18) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(9) << mean << std::setw(9) << at(0.5) << std::setw(9) << at(0.9)
+              << std::setw(9) << at(0.99) << std::setw(9) << at(0.999) << std::setw(11) << at(1.) << std::endl;
+}
+
+struct InputClass
+{
+    std::string name;
+    double a, b, c;
+};
+
+// median and p99 of every input class, and the spread of the medians over the classes.
+// Blocks of calls are timed, and the classes take turns in every round,
+// so the timer resolution and the drift of the CPU frequency do not favor any class.
+template <typename F>
+void report_classes(const std::string &name, const std::vector<InputClass> &classes, const size_t rounds, F f)
+{
+    constexpr size_t block = 64;
+    std::vector<std::vector<double>> ns(classes.size(), std::vector<double>(rounds));
+    double sink = 0;
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        for (size_t k = 0; k < classes.size(); ++k)
+        {
+            double x1 = 0, x2 = 0;
+            QuadtraticEquationSolver<double> solver(classes[k].a, classes[k].b, classes[k].c);
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t j = 0; j < block; ++j)
+            {
+                sink += x1 + x2 + static_cast<double>(f(solver, x1, x2));
+            }
+            const auto stop = std::chrono::steady_clock::now();
+            ns[k][r] = std::chrono::duration<double, std::nano>(stop - start).count() / block;
+        }
+    }
+    volatile double keep = sink;
+    (void)keep;
+
+    double lo = std::numeric_limits<double>::infinity(), hi = 0;
+    std::cout << name << std::endl;
+    for (size_t k = 0; k < classes.size(); ++k)
+    {
+        std::sort(ns[k].begin(), ns[k].end());
+        const double p50 = ns[k][(rounds - 1) / 2];
+        const double p99 = ns[k][(rounds - 1) * 99 / 100];
+        lo = std::min(lo, p50);
+        hi = std::max(hi, p50);
+        std::cout << "  " << std::left << std::setw(24) << classes[k].name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(9) << p50 << std::setw(9) << p99 << std::endl;
+    }
+    std::cout << "  " << std::left << std::setw(24) << "spread of p50" << std::right << std::setw(9) << hi - lo << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    const size_t n = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    std::mt19937_64 gen(2025);
+    std::uniform_real_distribution<double> frac(0.5, 1);
+    std::uniform_int_distribution<int> common(-8, 8);
+    std::uniform_int_distribution<int> wide(-1000, 1000);
+    std::uniform_real_distribution<double> u(0, 1);
+    std::vector<double> a(n), b(n), c(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double r = u(gen);
+        auto number = [&](std::uniform_int_distribution<int> &e)
+        {
+            const double x = std::ldexp(frac(gen), e(gen));
+            return u(gen) < 0.5 ? -x : x;
+        };
+        auto &e = r < 0.05 ? wide : common;
+        a[i] = number(e);
+        b[i] = number(e);
+        c[i] = number(e);
+        if (r > 0.95)
+        {
+            // nearly equal roots, where the Kahan discriminant needs the exact products
+            c[i] = b[i] * b[i] / (4 * a[i]) * (1 + 1e-15 * u(gen));
+        }
+        if (r > 0.99)
+        {
+            (u(gen) < 0.5 ? a[i] : b[i]) = 0;
+        }
+    }
+
+    // timer overhead, measured with an empty call
+    std::vector<double> empty = measure(a, b, c, [](QuadtraticEquationSolver<double> &, double &, double &)
+                                        { return UNCERTAIN; });
+    std::sort(empty.begin(), empty.end());
+    const double overhead = empty[empty.size() / 2];
+
+    std::vector<double> t_solve = measure(a, b, c, [](QuadtraticEquationSolver<double> &s, double &x1, double &x2)
+                                          { return s.solve(x1, x2); });
+    std::vector<double> t_branchless = measure(a, b, c, [](QuadtraticEquationSolver<double> &s, double &x1, double &x2)
+                                               { return s.solve_branchless(x1, x2); });
+
+    std::cout << "Equations: " << n << ", timer overhead " << overhead << " ns subtracted" << std::endl;
+    std::cout << std::left << std::setw(18) << "latency (ns)" << std::right << std::setw(9) << "mean" << std::setw(9) << "p50"
+              << std::setw(9) << "p90" << std::setw(9) << "p99" << std::setw(9) << "p99.9" << std::setw(11) << "max" << std::endl;
+    report("solve", t_solve, overhead);
+    report("solve_branchless", t_branchless, overhead);
+
+    const std::vector<InputClass> classes = {
+        {"common (1, -3, 2)", 1, -3, 2},
+        {"no root (1, 1, 1)", 1, 1, 1},
+        {"double root (1, -2, 1)", 1, -2, 1},
+        {"tiny c (1, -3, 1e-300)", 1, -3, 1e-300},
+        {"huge c (1, -3, 1e300)", 1, -3, 1e300},
+        {"subnormal a", std::numeric_limits<double>::denorm_min(), -3, 2},
+        {"no b (1, 0, -2)", 1, 0, -2},
+        {"no c (1, -3, 0)", 1, -3, 0},
+        {"linear (0, -3, 2)", 0, -3, 2},
+    };
+    const size_t rounds = std::max<size_t>(n / 500, 100);
+    std::cout << std::endl
+              << "Per input class, " << rounds << " blocks of 64 calls each" << std::endl;
+    std::cout << "  " << std::left << std::setw(24) << "latency (ns)" << std::right << std::setw(9) << "p50" << std::setw(9) << "p99" << std::endl;
+    report_classes("solve", classes, rounds, [](QuadtraticEquationSolver<double> &s, double &x1, double &x2)
+                   { return s.solve(x1, x2); });
+    report_classes("solve_branchless", classes, rounds, [](QuadtraticEquationSolver<double> &s, double &x1, double &x2)
+                   { return s.solve_branchless(x1, x2); });
+    return 0;
+}
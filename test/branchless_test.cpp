@@ -0,0 +1,39 @@
+#include "test/test.h"
+
+template <typename T>
+bool test_branchless(const std::string &data_type)
+{
+    std::vector<T> a, b, c;
+    edge_coefficients(a, b, c);
+    random_coefficients(200000, a, b, c);
+    random_coefficients(200000, a, b, c, 7, 8);
+    bool same = true;
+    size_t n_diff = 0;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        T r1(0), r2(0), x1(0), x2(0);
+        QuadtraticEquationSolver<T> solver(a[i], b[i], c[i]);
+        const SolverState s = solver.solve(r1, r2);
+        QuadtraticEquationSolver<T> branchless(a[i], b[i], c[i]);
+        const SolverState t = branchless.solve_branchless(x1, x2);
+        if (!is_identical_result(s, r1, r2, t, x1, x2))
+        {
+            if (n_diff++ < 8)
+            {
+                print_info(a[i], b[i], c[i]);
+                std::cout << "  solve:            " << QuadtraticEquationSolver<T>::print_solver_state(s) << " " << r1 << " " << r2 << std::endl;
+                std::cout << "  solve_branchless: " << QuadtraticEquationSolver<T>::print_solver_state(t) << " " << x1 << " " << x2 << std::endl;
+            }
+            same = false;
+        }
+    }
+    return check(data_type + " branchless solve is identical to solve", same);
+}
+
+int main()
+{
+    bool ok = true;
+    ok = test_branchless<float>("float") && ok;
+    ok = test_branchless<double>("double") && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+#include <thread>
+#include "test/test.h"
+#include "QuadraticEquationSolveCache.h"
+
+template <typename T>
+bool test_cache(const std::string &data_type)
+{
+    // a small pool of triples, drawn repeatedly as shared or instanced primitives
+    std::vector<T> pa, pb, pc;
+    edge_coefficients(pa, pb, pc);
+    random_coefficients(5000, pa, pb, pc);
+    random_coefficients(5000, pa, pb, pc, 7, 8);
+    std::vector<SolverState> ps(pa.size());
+    std::vector<T> px1(pa.size()), px2(pa.size());
+    for (size_t i = 0; i < pa.size(); ++i)
+    {
+        QuadtraticEquationSolver<T> solver(pa[i], pb[i], pc[i]);
+        ps[i] = solver.solve(px1[i], px2[i]);
+    }
+    constexpr size_t n = 200000;
+    std::mt19937_64 gen(11);
+    std::uniform_int_distribution<size_t> pick(0, pa.size() - 1);
+    std::vector<size_t> id(n);
+    std::vector<T> a(n), b(n), c(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        id[i] = pick(gen);
+        a[i] = pa[id[i]];
+        b[i] = pb[id[i]];
+        c[i] = pc[id[i]];
+    }
+
+    // single equations
+    QuadraticSolveCache<T> cache(size_t(1) << 15);
+    bool single = true;
+    for (size_t i = 0; i < n; ++i)
+    {
+        T r1(0), r2(0);
+        const SolverState s = cache.solve(a[i], b[i], c[i], r1, r2);
+        single = single && is_identical_result(ps[id[i]], px1[id[i]], px2[id[i]], s, r1, r2);
+    }
+    std::cout << data_type << ": " << cache.hits() << " hits, " << cache.misses() << " misses" << std::endl;
+    const bool counted = cache.hits() + cache.misses() == n && cache.hits() > n / 2;
+
+    // batch, into plain arrays and packed results
+    std::vector<SolverState> s(n);
+    std::vector<T> r1(n), r2(n);
+    cache.solve_batch(a.data(), b.data(), c.data(), n, s.data(), r1.data(), r2.data());
+    PackedSolverResults<T> packed;
+    cache.solve_batch(a.data(), b.data(), c.data(), n, packed);
+    bool batch = packed.size() == n;
+    size_t i = 0;
+    for (const auto v : packed)
+    {
+        batch = batch && is_identical_result(ps[id[i]], px1[id[i]], px2[id[i]], s[i], r1[i], r2[i]);
+        batch = batch && is_identical_result(ps[id[i]], px1[id[i]], px2[id[i]], v.state, v.x1, v.x2);
+        ++i;
+    }
+
+    // many threads sharing a small cache, so slots are overwritten while being read
+    QuadraticSolveCache<T> shared(256);
+    std::atomic<bool> threaded(true);
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < 4; ++t)
+    {
+        // every equation is solved by two of the threads
+        threads.emplace_back([&, t]()
+                             {
+                                 for (size_t i = t; i < n; i += 2)
+                                 {
+                                     T x1(0), x2(0);
+                                     const SolverState u = shared.solve(a[i], b[i], c[i], x1, x2);
+                                     if (!is_identical_result(ps[id[i]], px1[id[i]], px2[id[i]], u, x1, x2))
+                                     {
+                                         threaded = false;
+                                     }
+                                 }
+                             });
+    }
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+
+    bool ok = true;
+    ok = check(data_type + " cached single solve is identical to solve", single) && ok;
+    ok = check(data_type + " cache counts hits and misses", counted) && ok;
+    ok = check(data_type + " cached batch solve is identical to solve", batch) && ok;
+    ok = check(data_type + " shared cache between threads is identical to solve", threaded) && ok;
+    return ok;
+}
+
+int main()
+{
+    bool ok = true;
+    ok = test_cache<float>("float") && ok;
+    ok = test_cache<double>("double") && ok;
+    return ok ? 0 : 1;
+}
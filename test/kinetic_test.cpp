@@ -0,0 +1,129 @@
+#include "test/test.h"
+#include "QuadraticEquationKineticScheduler.h"
+
+template <typename T>
+void random_equation(std::mt19937_64 &gen, const T now, T &a, T &b, T &c)
+{
+    // roots around the current time, sometimes none of them in the future
+    std::uniform_real_distribution<T> u(-1, 10);
+    const T r1 = now + u(gen);
+    const T r2 = now + u(gen);
+    a = u(gen) + 2;
+    b = -a * (r1 + r2);
+    c = a * r1 * r2 + (u(gen) < 0 ? 100 : 0);
+}
+
+template <typename T>
+bool test_kinetic(const std::string &data_type)
+{
+    constexpr size_t n = 2000;
+    constexpr T inf = std::numeric_limits<T>::infinity();
+    std::mt19937_64 gen(7);
+    std::uniform_int_distribution<size_t> pick(0, n - 1);
+    KineticEventScheduler<T> scheduler;
+    std::vector<T> a(n), b(n), c(n), expect(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        random_equation(gen, scheduler.now(), a[i], b[i], c[i]);
+        scheduler.set(i, a[i], b[i], c[i]);
+        expect[i] = KineticEventScheduler<T>::earliest_root(a[i], b[i], c[i], scheduler.now());
+    }
+
+    bool in_order = true;
+    bool is_earliest = true;
+    bool is_future = true;
+    size_t id = 0;
+    T t = 0, last = scheduler.now();
+    for (size_t step = 0; step < 5 * n && scheduler.pop(id, t); ++step)
+    {
+        // the popped event must be the earliest among all the brute force event times
+        T earliest = inf;
+        for (size_t i = 0; i < n; ++i)
+        {
+            earliest = std::min(earliest, expect[i]);
+        }
+        is_earliest = is_earliest && t == earliest && expect[id] == t;
+        in_order = in_order && last <= t;
+        is_future = is_future && scheduler.event_time(id) == inf && !scheduler.contains(id);
+        last = t;
+        expect[id] = inf;
+
+        // the object changes, so re-solve this pair and some affected ones, alternating single and batch updates
+        std::vector<size_t> ids = {id, pick(gen), pick(gen), pick(gen)};
+        std::vector<T> ba(ids.size()), bb(ids.size()), bc(ids.size());
+        for (size_t j = 0; j < ids.size(); ++j)
+        {
+            random_equation(gen, scheduler.now(), ba[j], bb[j], bc[j]);
+            expect[ids[j]] = KineticEventScheduler<T>::earliest_root(ba[j], bb[j], bc[j], scheduler.now());
+        }
+        if (step & 1)
+        {
+            scheduler.set_batch(ids.data(), ba.data(), bb.data(), bc.data(), ids.size());
+        }
+        else
+        {
+            for (size_t j = 0; j < ids.size(); ++j)
+            {
+                scheduler.set(ids[j], ba[j], bb[j], bc[j]);
+            }
+        }
+        if (step % 97 == 0)
+        {
+            const size_t k = pick(gen);
+            scheduler.erase(k);
+            expect[k] = inf;
+        }
+    }
+
+    // a large batch rebuilds the whole heap
+    std::vector<size_t> ids(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        ids[i] = i;
+        random_equation(gen, scheduler.now(), a[i], b[i], c[i]);
+        expect[i] = KineticEventScheduler<T>::earliest_root(a[i], b[i], c[i], scheduler.now());
+    }
+    scheduler.set_batch(ids.data(), a.data(), b.data(), c.data(), n);
+    std::vector<T> sorted;
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (expect[i] != inf)
+        {
+            sorted.push_back(expect[i]);
+        }
+    }
+    std::sort(sorted.begin(), sorted.end());
+    bool rebuilt = scheduler.size() == sorted.size();
+    for (size_t i = 0; i < sorted.size() && rebuilt; ++i)
+    {
+        rebuilt = scheduler.pop(id, t) && t == sorted[i] && expect[id] == t;
+    }
+    rebuilt = rebuilt && scheduler.empty();
+
+    // the other root overflows, but the finite one is still an event
+    constexpr T d = std::numeric_limits<T>::denorm_min();
+    KineticEventScheduler<T> overflow;
+    overflow.set(0, d, -1, 1);
+    const size_t overflow_id[] = {1};
+    const T oa[] = {d}, ob[] = {-1}, oc[] = {2};
+    overflow.set_batch(overflow_id, oa, ob, oc, 1);
+    bool one_finite = overflow.event_time(0) == 1 && overflow.event_time(1) == 2;
+    one_finite = one_finite && overflow.pop(id, t) && id == 0 && t == 1;
+    one_finite = one_finite && overflow.pop(id, t) && id == 1 && t == 2 && overflow.empty();
+
+    bool ok = true;
+    ok = check(data_type + " kinetic events are the earliest", is_earliest) && ok;
+    ok = check(data_type + " kinetic events are in time order", in_order) && ok;
+    ok = check(data_type + " kinetic popped events leave the queue", is_future) && ok;
+    ok = check(data_type + " kinetic batch update rebuilds the queue", rebuilt) && ok;
+    ok = check(data_type + " kinetic overflowed result keeps its finite root", one_finite) && ok;
+    return ok;
+}
+
+int main()
+{
+    bool ok = true;
+    ok = test_kinetic<float>("float") && ok;
+    ok = test_kinetic<double>("double") && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,73 @@
+#include "test/test.h"
+#include "QuadraticEquationPackedResults.h"
+
+static_assert(std::forward_iterator<PackedSolverResults<double>::const_iterator>);
+
+template <typename T>
+bool test_packed(const std::string &data_type)
+{
+    std::vector<T> a, b, c;
+    edge_coefficients(a, b, c);
+    random_coefficients(100000, a, b, c);
+    const size_t n = a.size();
+
+    PackedSolverResults<T> packed;
+    packed.solve_batch(a.data(), b.data(), c.data(), n);
+
+    std::vector<SolverState> s(n), t(n);
+    std::vector<T> r1(n), r2(n), x1(n), x2(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        QuadtraticEquationSolver<T> solver(a[i], b[i], c[i]);
+        s[i] = solver.solve(r1[i], r2[i]);
+    }
+
+    bool by_index = packed.size() == n;
+    for (size_t i = 0; i < n && by_index; ++i)
+    {
+        T y1(0), y2(0);
+        const SolverState u = packed.get(i, y1, y2);
+        by_index = is_identical_result(s[i], r1[i], r2[i], u, y1, y2) && packed.state(i) == s[i];
+    }
+
+    bool by_iterator = true;
+    size_t i = 0;
+    for (const auto v : packed)
+    {
+        by_iterator = by_iterator && is_identical_result(s[i], r1[i], r2[i], v.state, v.x1, v.x2);
+        ++i;
+    }
+    by_iterator = by_iterator && i == n;
+    by_iterator = by_iterator && static_cast<size_t>(std::distance(packed.begin(), packed.end())) == packed.size();
+    auto it = packed.begin();
+    const auto first = *it++;
+    by_iterator = by_iterator && is_identical_result(s[0], r1[0], r2[0], first.state, first.x1, first.x2);
+    by_iterator = by_iterator && std::ranges::count_if(packed, [](const auto &v)
+                                                       { return TWO_REAL == v.state; }) == std::count(s.begin(), s.end(), TWO_REAL);
+
+    packed.unpack(t.data(), x1.data(), x2.data());
+    bool by_unpack = true;
+    for (size_t i = 0; i < n; ++i)
+    {
+        by_unpack = by_unpack && is_identical_result(s[i], r1[i], r2[i], t[i], x1[i], x2[i]);
+    }
+
+    const size_t full = n * (sizeof(SolverState) + 2 * sizeof(T));
+    const size_t compact = n + packed.root_count() * sizeof(T) + (n / 64 + 1) * sizeof(size_t);
+    std::cout << data_type << ": " << n << " results, " << full << " bytes unpacked, "
+              << compact << " bytes packed" << std::endl;
+
+    bool ok = true;
+    ok = check(data_type + " packed results by index", by_index) && ok;
+    ok = check(data_type + " packed results by iterator", by_iterator) && ok;
+    ok = check(data_type + " packed results by unpack", by_unpack) && ok;
+    return ok;
+}
+
+int main()
+{
+    bool ok = true;
+    ok = test_packed<float>("float") && ok;
+    ok = test_packed<double>("double") && ok;
+    return ok ? 0 : 1;
+}
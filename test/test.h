@@ -1,7 +1,10 @@
 #pragma once
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 #include <iostream>
+#include <random>
+#include <vector>
 #include "QuadraticEquationSolver.h"
 
 constexpr auto RESET = "\033[0m";
@@ -195,3 +198,70 @@ void demo(const char *tips, const T a, const T b, const T c)
     std::cout << "+-------+" << std::string(w, '-') << "+" << std::string(w, '-') << "+\n"
               << std::endl;
 }
+
+template <typename T>
+bool is_identical_root(const T x, const T y)
+{
+    // bitwise equal, except that any NaN equals any NaN
+    return (x == y && std::signbit(x) == std::signbit(y)) || (std::isnan(x) && std::isnan(y));
+}
+
+template <typename T>
+bool is_identical_result(const SolverState s, const T r1, const T r2, const SolverState t, const T x1, const T x2)
+{
+    return (s == t) && is_identical_root(r1, x1) && is_identical_root(r2, x2);
+}
+
+template <typename T>
+void edge_coefficients(std::vector<T> &a, std::vector<T> &b, std::vector<T> &c)
+{
+    // every combination of special values, including those leaving the common path
+    constexpr T p = std::numeric_limits<T>::min();
+    constexpr T q = std::numeric_limits<T>::max();
+    constexpr T d = std::numeric_limits<T>::denorm_min();
+    constexpr T inf = std::numeric_limits<T>::infinity();
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+    const std::vector<T> v = {0, -0.0, 1, -1, 2, -4, 4, 0.5, -3, p, -p, q, -q, d, -d, inf, -inf, nan,
+                              static_cast<T>(1e-20), static_cast<T>(-1e20), static_cast<T>(1e-30), static_cast<T>(3e30)};
+    for (const T x : v)
+    {
+        for (const T y : v)
+        {
+            for (const T z : v)
+            {
+                a.push_back(x);
+                b.push_back(y);
+                c.push_back(z);
+            }
+        }
+    }
+}
+
+template <typename T>
+void random_coefficients(const size_t n, std::vector<T> &a, std::vector<T> &b, std::vector<T> &c, const unsigned seed = 2025, const int e_lim = 0)
+{
+    // random sign, fraction and exponent over the whole finite range, or within [-e_lim, e_lim] if given
+    constexpr int e_max = std::numeric_limits<T>::max_exponent;
+    constexpr int e_min = std::numeric_limits<T>::min_exponent;
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<T> frac(0.5, 1);
+    std::uniform_int_distribution<int> expo(e_lim > 0 ? -e_lim : e_min, e_lim > 0 ? e_lim : e_max - 1);
+    std::uniform_int_distribution<int> flip(0, 1);
+    auto random_number = [&]()
+    {
+        const T x = std::ldexp(frac(gen), expo(gen));
+        return flip(gen) ? -x : x;
+    };
+    for (size_t i = 0; i < n; ++i)
+    {
+        a.push_back(random_number());
+        b.push_back(random_number());
+        c.push_back(random_number());
+    }
+}
+
+inline bool check(const std::string &tips, const bool ok)
+{
+    std::cout << (ok ? GREEN : RED) << (ok ? "[PASS] " : "[FAIL] ") << RESET << tips << std::endl;
+    return ok;
+}
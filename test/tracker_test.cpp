@@ -0,0 +1,64 @@
+#include "test/test.h"
+#include "QuadraticEquationRootTracker.h"
+
+template <typename T>
+T ulp_distance(const T x, const T y)
+{
+    // distance in units of the last place of the larger magnitude
+    const T m = std::max(std::fabs(x), std::fabs(y));
+    const T ulp = std::nextafter(m, std::numeric_limits<T>::infinity()) - m;
+    return std::fabs(x - y) / ulp;
+}
+
+template <typename T>
+bool test_tracker(const std::string &data_type, const T scale)
+{
+    constexpr size_t n = 200000;
+    constexpr T pi = static_cast<T>(3.14159265358979323846);
+    bool same_state = true;
+    T max_ulp = 0;
+    size_t n_two_real = 0;
+    QuadraticRootTracker<T> tracker;
+    for (size_t i = 0; i < n; ++i)
+    {
+        // slowly moving roots, which merge, disappear and come back periodically
+        const T t = static_cast<T>(i) / static_cast<T>(n);
+        const T a = scale * (1 + std::sin(2 * pi * t) / 4);
+        const T m = 3 + std::cos(6 * pi * t);
+        const T h = std::sin(10 * pi * t);
+        const T b = -2 * a * m;
+        const T c = a * (m * m - h);
+        T r1(0), r2(0), x1(0), x2(0);
+        const SolverState s = tracker.track(a, b, c, r1, r2);
+        QuadtraticEquationSolver<T> solver(a, b, c);
+        const SolverState u = solver.solve(x1, x2);
+        same_state = same_state && s == u;
+        if (TWO_REAL == s && TWO_REAL == u)
+        {
+            ++n_two_real;
+            max_ulp = std::max(max_ulp, std::max(ulp_distance(r1, x1), ulp_distance(r2, x2)));
+        }
+        if (ONE_REAL == s && ONE_REAL == u)
+        {
+            max_ulp = std::max(max_ulp, ulp_distance(r1, x1));
+        }
+    }
+    std::cout << data_type << ": " << tracker.newton_count() << " Newton updates, "
+              << tracker.solve_count() << " full solves, " << n_two_real << " with two roots, max distance " << max_ulp << " ULP" << std::endl;
+
+    bool ok = true;
+    ok = check(data_type + " tracked state is the same as solve", same_state) && ok;
+    ok = check(data_type + " tracked roots are within the ULP bound", max_ulp <= QuadraticRootTracker<T>::ulp_bound) && ok;
+    ok = check(data_type + " tracked roots mostly skip the full solve", tracker.newton_count() > 9 * n_two_real / 10) && ok;
+    return ok;
+}
+
+int main()
+{
+    bool ok = true;
+    ok = test_tracker<float>("float", 1.f) && ok;
+    ok = test_tracker<float>("float, small a", 1e-10f) && ok;
+    ok = test_tracker<double>("double", 1.) && ok;
+    ok = test_tracker<double>("double, large a", 1e200) && ok;
+    return ok ? 0 : 1;
+}